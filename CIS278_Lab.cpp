@@ -7,6 +7,9 @@
 #include <string>
 #include <stdexcept>          // <-- for the exception below
 #include <sstream>   // for ostringstream
+#include <climits>   // for LONG_MAX
+#include <algorithm> // for std::min
+#include <deque>     // calls waiting for a free elevator
 
 // Enumeration for elevator direction
 enum class Direction { IDLE, UP, DOWN };
@@ -61,6 +64,23 @@ public:
         }
     }
 
+    // Steps that only travel before arriving (LONG_MAX if no request)
+    long stepsUntilArrival() const {
+        if (targetFloor == -1) return LONG_MAX;
+        return std::abs(targetFloor - currentFloor) - 1;
+    }
+
+    // Same as calling step() `steps` times when no arrival happens in between
+    void advance(long steps) {
+        if (steps <= 0) return;
+        if (targetFloor == -1) {
+            direction = Direction::IDLE;
+            return;
+        }
+        if      (direction == Direction::UP)   currentFloor += (int)steps;
+        else if (direction == Direction::DOWN) currentFloor -= (int)steps;
+    }
+
     void openDoors() {
         doorOpen = true;
         std::cout << "Elevator " << id
@@ -79,10 +99,56 @@ public:
 class Building {
     int                 floors;
     std::vector<Elevator> elevators;
+    long                clock;      // steps simulated so far
+
+    // Hall-call table: floor -> index of the elevator answering it,
+    // NO_CALL if the button is not lit, QUEUED while waiting for a car
+    enum { NO_CALL = -1, QUEUED = -2 };
+    std::vector<int>    hallCalls;
+    std::deque<int>     pendingCalls;
+
+    int nearestIdle(int floor) const {
+        int chosenIndex = -1;
+        int minDistance = floors + 1;
+        for (int i = 0; i < (int)elevators.size(); ++i) {
+            if (elevators[i].direction == Direction::IDLE) {
+                int d = std::abs(elevators[i].currentFloor - floor);
+                if (d < minDistance) {
+                    minDistance  = d;
+                    chosenIndex  = i;
+                }
+            }
+        }
+        return chosenIndex;
+    }
+
+    void assign(int index, int floor) {
+        hallCalls[floor] = index;
+        elevators[index].addRequest(floor);
+        std::cout << "Request for floor " << floor
+                  << " assigned to Elevator "
+                  << elevators[index].id << "\n";
+        if (elevators[index].targetFloor == -1) {
+            hallCalls[floor] = NO_CALL;   // was already there
+        }
+    }
+
+    // Hand queued calls to elevators that became free
+    void assignPending() {
+        while (!pendingCalls.empty()) {
+            int index = nearestIdle(pendingCalls.front());
+            if (index < 0) break;
+            int floor = pendingCalls.front();
+            pendingCalls.pop_front();
+            assign(index, floor);
+        }
+    }
 
 public:
     Building(int totalFloors, int numElevators)
       : floors(totalFloors)
+      , clock(0)
+      , hallCalls(totalFloors + 1, NO_CALL)
     {
         for (int i = 0; i < numElevators; ++i) {
             elevators.emplace_back(i + 1, 1);
@@ -94,46 +160,61 @@ public:
             throw std::runtime_error("No elevators available");
         }
 
-        int chosenIndex = -1;
-        int minDistance = floors + 1;
-
-        // 1) Prefer idle elevators
-        for (int i = 0; i < (int)elevators.size(); ++i) {
-            if (elevators[i].direction == Direction::IDLE) {
-                int d = std::abs(elevators[i].currentFloor - floor);
-                if (d < minDistance) {
-                    minDistance  = d;
-                    chosenIndex  = i;
-                }
-            }
+        if (floor < 1 || floor > floors) {
+            throw std::out_of_range("Floor out of range");
         }
 
-        // 2) Fallback to any elevator
-        if (chosenIndex == -1) {
-            for (int i = 0; i < (int)elevators.size(); ++i) {
-                int d = std::abs(elevators[i].currentFloor - floor);
-                if (d < minDistance) {
-                    minDistance  = d;
-                    chosenIndex  = i;
-                }
-            }
+        // Same button pressed again: coalesce, never send a second car
+        if (hallCalls[floor] != NO_CALL) {
+            std::cout << "Request for floor " << floor
+                      << " already pending\n";
+            return;
         }
 
-        // Sanity check (should never happen if numElevators > 0)
+        // Only idle elevators take new calls; a busy one would lose its
+        // current target, so the call waits until a car is free
+        int chosenIndex = nearestIdle(floor);
         if (chosenIndex < 0) {
-            throw std::logic_error("Failed to select an elevator");
+            hallCalls[floor] = QUEUED;
+            pendingCalls.push_back(floor);
+            std::cout << "Request for floor " << floor
+                      << " queued until an elevator is free\n";
+            return;
         }
-
-        elevators[chosenIndex].addRequest(floor);
-        std::cout << "Request for floor " << floor
-                  << " assigned to Elevator "
-                  << elevators[chosenIndex].id << "\n";
+        assign(chosenIndex, floor);
     }
 
     void step() {
-        for (auto &e : elevators) e.step();
+        for (auto &e : elevators) {
+            bool busy = e.targetFloor != -1;
+            e.step();
+            if (busy && e.targetFloor == -1) {
+                hallCalls[e.currentFloor] = NO_CALL;
+            }
+        }
+        assignPending();
+        ++clock;
     }
 
+    // Event-driven advance: jump straight to the next arrival instead of
+    // stepping floor by floor; ends in the same state as repeated step()
+    void advanceTo(long tick) {
+        while (clock < tick) {
+            long skip = tick - clock;
+            for (auto const &e : elevators)
+                skip = std::min(skip, e.stepsUntilArrival());
+
+            if (skip == 0) {
+                step();
+                continue;
+            }
+            for (auto &e : elevators) e.advance(skip);
+            clock += skip;
+        }
+    }
+
+    long currentTick() const { return clock; }
+
     void displayStatus() const {
         std::cout << "Current Elevator Status:\n";
         for (auto const &e : elevators) {
@@ -236,7 +317,12 @@ extern "C" {
 
     // Called from JS to submit a floor request
     void addRequest(int floor) {
-        gBuilding.requestElevator(floor);
+        try {
+            gBuilding.requestElevator(floor);
+        }
+        catch (const std::exception &) {
+            // ignore invalid floors coming from the page
+        }
     }
 
     // Advance the entire simulation by one step
@@ -244,6 +330,11 @@ extern "C" {
         gBuilding.step();
     }
 
+    // Advance many steps at once, jumping straight to the next arrival
+    void advanceSimulation(int steps) {
+        gBuilding.advanceTo(gBuilding.currentTick() + steps);
+    }
+
     // Returns a pointer to a null‑terminated C string in Wasm memory
     const char* getStatus() {
         // we must keep the buffer alive; static here will persist
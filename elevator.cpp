@@ -4,15 +4,46 @@
 #include <chrono>
 #include <algorithm>
 #include <sstream>    // for serializeStatus()
+#include <climits>    // for LONG_MAX in the event-driven clock
+#include <mutex>      // per-zone worker threads
+#include <condition_variable>
+#include <stdexcept>  // for invalid zone layouts
 using namespace std;
 
 // ----------------------------------
 // Elevator class
 // ----------------------------------
+// A car's planned sweep over the stops it has to make, used for ETA
+// estimates. Stops are sorted once so each estimate is a binary search.
+struct Sweep {
+    int  from;           // current floor
+    bool up;
+    bool idle;           // no stops at all
+    int  turn;           // furthest floor of this sweep
+    vector<int> ahead;   // stops of this sweep, ascending
+
+    // Ticks to reach `floor`: one per floor travelled plus one per door
+    // stop on the way
+    long etaTo(int floor) const {
+        if (idle) return abs(floor - from);
+        bool onTheWay = up ? (floor >= from && floor <= turn)
+                           : (floor <= from && floor >= turn);
+        if (onTheWay) {
+            int lo = up ? from : floor, hi = up ? floor : from;
+            long stops = lower_bound(ahead.begin(), ahead.end(), hi)
+                       - upper_bound(ahead.begin(), ahead.end(), lo);
+            return abs(floor - from) + max(0L, stops);
+        }
+        return abs(turn - from) + abs(turn - floor) + (long)ahead.size();
+    }
+};
+
 class Elevator {
 public:
     int id;
     int currentFloor;
+    int lowFloor;     // served-floor range (zoned buildings)
+    int highFloor;
     bool doorOpen;
     bool goingUp;
     bool idle;
@@ -20,14 +51,20 @@ public:
     vector<int> upRequests;
     vector<int> downRequests;
 
-    Elevator(int elevatorId)
+    Elevator(int elevatorId, int low = 1, int high = INT_MAX)
       : id(elevatorId)
-      , currentFloor(1)
+      , currentFloor(low)
+      , lowFloor(low)
+      , highFloor(high)
       , doorOpen(false)
       , goingUp(true)
       , idle(true)
     {}
 
+    bool serves(int floor) const {
+        return floor >= lowFloor && floor <= highFloor;
+    }
+
     // Enqueue a request, avoid duplicates
     void addRequest(int floor, bool up) {
         auto& queue = up ? upRequests : downRequests;
@@ -42,32 +79,35 @@ public:
         }
     }
 
-    // Move one step: travel toward target or open/close doors
-    void move() {
+    // Drop a stop from both queues (call taken over by another car)
+    void removeRequest(int floor) {
+        upRequests.erase(remove(upRequests.begin(), upRequests.end(), floor),
+                         upRequests.end());
+        downRequests.erase(remove(downRequests.begin(), downRequests.end(), floor),
+                           downRequests.end());
+    }
+
+    // Move one step: travel toward target or open/close doors.
+    // Returns true when doors opened at currentFloor this step.
+    bool move(ostream& out = cout) {
         if (upRequests.empty() && downRequests.empty()) {
             idle = true;
-            return;
+            return false;
         }
         idle = false;
 
-        // Switch direction if current queue empty
-        if (goingUp && upRequests.empty() && !downRequests.empty())
-            goingUp = false;
-        else if (!goingUp && downRequests.empty() && !upRequests.empty())
-            goingUp = true;
-
-        // Determine next target
-        int target = goingUp
-                   ? (upRequests.empty()   ? currentFloor : upRequests.front())
-                   : (downRequests.empty() ? currentFloor : downRequests.front());
+        // Switch direction if current queue empty, then pick next target
+        goingUp = sweepUp();
+        int target = nextTarget();
 
         // Arrive at target?
         if (currentFloor == target) {
-            openDoors();
+            openDoors(out);
             if (goingUp && !upRequests.empty())
                 upRequests.erase(upRequests.begin());
             else if (!goingUp && !downRequests.empty())
                 downRequests.erase(downRequests.begin());
+            return true;
         }
         // Move one floor
         else if (target > currentFloor) {
@@ -76,20 +116,68 @@ public:
         else {
             --currentFloor;
         }
+        return false;
+    }
+
+    // Number of move() calls that only travel before the next door opening
+    // (0 means the very next move() opens doors); LONG_MAX when no requests
+    long ticksUntilArrival() const {
+        if (upRequests.empty() && downRequests.empty())
+            return LONG_MAX;
+        return abs(nextTarget() - currentFloor);
     }
 
-    void openDoors() {
+    // Same effect as calling move() `ticks` times, provided no arrival
+    // happens in between (ticks <= ticksUntilArrival())
+    void advance(long ticks) {
+        if (ticks <= 0) return;
+        if (upRequests.empty() && downRequests.empty()) {
+            idle = true;
+            return;
+        }
+        idle = false;
+        goingUp = sweepUp();
+        int target = nextTarget();
+        currentFloor += (target > currentFloor) ? (int)ticks : -(int)ticks;
+    }
+
+    // Sweep this car would make without the stops in `dropped`
+    Sweep plannedSweep(vector<int> const& dropped) const {
+        auto kept = [&](vector<int> const& queue) {
+            vector<int> out;
+            for (int f : queue)
+                if (find(dropped.begin(), dropped.end(), f) == dropped.end())
+                    out.push_back(f);
+            return out;
+        };
+        vector<int> ups = kept(upRequests), downs = kept(downRequests);
+
+        Sweep plan;
+        plan.from = currentFloor;
+        plan.up   = sweepUp(goingUp, ups.empty(), downs.empty());
+        plan.idle = ups.empty() && downs.empty();
+        plan.turn = currentFloor;
+        if (plan.idle) return plan;
+
+        plan.ahead = plan.up ? ups : downs;
+        sort(plan.ahead.begin(), plan.ahead.end());
+        plan.turn = plan.up ? max(currentFloor, plan.ahead.back())
+                            : min(currentFloor, plan.ahead.front());
+        return plan;
+    }
+
+    void openDoors(ostream& out = cout) {
         doorOpen = true;
-        cout << "\nElevator " << id
-             << ": Doors opening at floor " << currentFloor << "\n";
+        out << "\nElevator " << id
+            << ": Doors opening at floor " << currentFloor << "\n";
         this_thread::sleep_for(chrono::seconds(3));
-        closeDoors();
+        closeDoors(out);
     }
 
-    void closeDoors() {
+    void closeDoors(ostream& out = cout) {
         if (!doorOpen) return;
         doorOpen = false;
-        cout << "Elevator " << id << ": Doors closing.\n";
+        out << "Elevator " << id << ": Doors closing.\n";
         this_thread::sleep_for(chrono::seconds(1));
     }
 
@@ -100,48 +188,96 @@ public:
              << " | Doors " << (doorOpen ? "Open" : "Closed")
              << "\n";
     }
+
+private:
+    // Direction move() travels in: switch if the current queue is empty
+    bool sweepUp() const {
+        return sweepUp(goingUp, upRequests.empty(), downRequests.empty());
+    }
+
+    static bool sweepUp(bool goingUp, bool upEmpty, bool downEmpty) {
+        if (goingUp && upEmpty && !downEmpty)
+            return false;
+        if (!goingUp && downEmpty && !upEmpty)
+            return true;
+        return goingUp;
+    }
+
+    // Stop move() heads for next; currentFloor when there are no requests
+    int nextTarget() const {
+        auto const& queue = sweepUp() ? upRequests : downRequests;
+        return queue.empty() ? currentFloor : queue.front();
+    }
 };
 
 // ----------------------------------
-// Building class
+// Zone class
 // ----------------------------------
-class Building {
+// A passenger trip; legTo is where the current car drops them off
+// (the final floor, or a sky lobby when the trip leaves this zone)
+struct Trip {
+    int from;
+    int to;
+    int legTo;
+    int car;      // elevator id once boarded, -1 while waiting
+};
+
+// One shard of a zoned building: a contiguous block of cars serving
+// [lowFloor, highFloor] with its own dispatcher and request queue.
+// Zones only touch their own cars, so each can be stepped on its own
+// thread; trips cross zones through the outbox at sky-lobby floors.
+class Zone {
 public:
-    vector<Elevator> elevators;
-    int numFloors;
+    int lowFloor;
+    int highFloor;
+    int firstCar;          // cars [firstCar, lastCar) of Building::elevators
+    int lastCar;
+    long delivered;        // trips completed inside this zone
 
-    Building(int totFloors, int totElev)
-      : numFloors(totFloors)
-    {
-        for (int i = 1; i <= totElev; ++i)
-            elevators.emplace_back(i);
+    vector<Trip> inbox;    // new trips and handoffs, drained on step()
+    vector<Trip> waiting;  // called a car, not yet boarded
+    vector<Trip> riding;
+    vector<Trip> outbox;   // reached a sky lobby, handed off after the tick
+    vector<pair<int, int>> arrivals;  // (car index, floor) doors opened this tick
+    ostringstream log;     // door messages of a parallel tick, printed after it
+
+    Zone(int low, int high, int first, int last)
+      : lowFloor(low)
+      , highFloor(high)
+      , firstCar(first)
+      , lastCar(last)
+      , delivered(0)
+    {}
+
+    bool serves(int floor) const {
+        return floor >= lowFloor && floor <= highFloor;
     }
 
-    // Step each elevator and show status if any moved
-    void stepAll() {
-        bool moved = false;
-        for (auto& el : elevators) {
-            int prev = el.currentFloor;
-            el.move();
-            if (el.currentFloor != prev) moved = true;
-        }
-        if (moved) showStatus();
+    // Drop-off floor for this zone: the destination or the nearest lobby
+    int legTarget(int to) const {
+        if (serves(to)) return to;
+        return to > highFloor ? highFloor : lowFloor;
     }
 
-    // Display all elevator states
-    void showStatus() const {
-        cout << "\n===== Building Status =====\n";
-        for (auto const& el : elevators)
-            el.showStatus();
+    bool ownsCar(int carIdx) const {
+        return carIdx >= firstCar && carIdx < lastCar;
     }
 
-    // Automatically dispatch the closest idle (or closest overall) elevator
-    void dispatch(int floor) {
-        int bestIdx = -1, bestDist = numFloors + 1;
+    // True if a rider in car `carId` still has to get off at `floor`
+    bool needsStop(int carId, int floor) const {
+        for (auto const& t : riding)
+            if (t.car == carId && t.legTo == floor) return true;
+        return false;
+    }
+
+    // Send the closest idle (or closest overall) car of this zone;
+    // returns its index in `cars`, or -1 if none serves the floor
+    int dispatch(vector<Elevator>& cars, int floor) {
+        int bestIdx = -1, bestDist = INT_MAX;
         // Prefer idle
-        for (int i = 0; i < (int)elevators.size(); ++i) {
-            if (elevators[i].idle) {
-                int d = abs(elevators[i].currentFloor - floor);
+        for (int i = firstCar; i < lastCar; ++i) {
+            if (cars[i].idle && cars[i].serves(floor)) {
+                int d = abs(cars[i].currentFloor - floor);
                 if (d < bestDist) {
                     bestDist = d;
                     bestIdx  = i;
@@ -150,18 +286,565 @@ public:
         }
         // Fallback to any if none idle
         if (bestIdx < 0) {
-            for (int i = 0; i < (int)elevators.size(); ++i) {
-                int d = abs(elevators[i].currentFloor - floor);
+            for (int i = firstCar; i < lastCar; ++i) {
+                if (!cars[i].serves(floor)) continue;
+                int d = abs(cars[i].currentFloor - floor);
                 if (d < bestDist) {
                     bestDist = d;
                     bestIdx  = i;
                 }
             }
         }
-        elevators[bestIdx].addRequest(floor,
-            floor > elevators[bestIdx].currentFloor);
-        cout << "Dispatched Elevator " << (bestIdx + 1)
+        if (bestIdx < 0) return -1;   // no car in this zone serves the floor
+        cars[bestIdx].addRequest(floor,
+            floor > cars[bestIdx].currentFloor);
+        cout << "Dispatched Elevator " << cars[bestIdx].id
              << " to floor " << floor << "\n";
+        return bestIdx;
+    }
+
+    // Advance this zone's cars one tick, writing door messages to `out`;
+    // true if any car changed floor
+    bool step(vector<Elevator>& cars, ostream& out) {
+        waiting.insert(waiting.end(), inbox.begin(), inbox.end());
+        inbox.clear();
+
+        bool moved = false;
+        for (int i = firstCar; i < lastCar; ++i) {
+            int prev = cars[i].currentFloor;
+            if (cars[i].move(out)) {
+                onArrival(cars[i]);
+                arrivals.push_back({i, cars[i].currentFloor});
+            }
+            if (cars[i].currentFloor != prev) moved = true;
+        }
+        return moved;
+    }
+
+private:
+    // Doors opened: drop riders whose leg ends here, board waiting trips
+    void onArrival(Elevator& el) {
+        int floor = el.currentFloor;
+        for (size_t i = 0; i < riding.size(); ) {
+            Trip const& t = riding[i];
+            if (t.car == el.id && t.legTo == floor) {
+                if (t.to == floor) ++delivered;
+                else               outbox.push_back({floor, t.to, 0, -1});
+                riding.erase(riding.begin() + i);
+            } else {
+                ++i;
+            }
+        }
+        for (size_t i = 0; i < waiting.size(); ) {
+            Trip t = waiting[i];
+            if (t.from == floor) {
+                t.car   = el.id;
+                t.legTo = legTarget(t.to);
+                el.addRequest(t.legTo, t.legTo > floor);
+                riding.push_back(t);
+                waiting.erase(waiting.begin() + i);
+            } else {
+                ++i;
+            }
+        }
+    }
+};
+
+// ----------------------------------
+// Hall-call table
+// ----------------------------------
+// Building-wide hall calls, one slot per (floor, direction) holding the
+// index of the car answering it. Lookups are O(1), so repeat presses of
+// the same button coalesce instead of sending another car.
+class HallCallTable {
+public:
+    explicit HallCallTable(int floors)
+      : owners(2 * (floors + 1), -1)
+      , count(0)
+    {}
+
+    int ownerOf(int floor, bool up) const {
+        return owners[slot(floor, up)];
+    }
+
+    bool pending(int floor, bool up) const {
+        return ownerOf(floor, up) >= 0;
+    }
+
+    // Record (or move) the car answering a call
+    void assign(int floor, bool up, int carIdx) {
+        int& owner = owners[slot(floor, up)];
+        if (owner < 0) ++count;
+        owner = carIdx;
+    }
+
+    void clear(int floor, bool up) {
+        int& owner = owners[slot(floor, up)];
+        if (owner >= 0) --count;
+        owner = -1;
+    }
+
+    int size() const { return count; }
+
+    // Every lit button as (floor, up)
+    vector<pair<int, bool>> pendingCalls() const {
+        vector<pair<int, bool>> calls;
+        calls.reserve(count);
+        for (size_t i = 0; i < owners.size(); ++i)
+            if (owners[i] >= 0)
+                calls.push_back({(int)(i / 2), i % 2 == 1});
+        return calls;
+    }
+
+private:
+    vector<int> owners;   // car index, -1 when the button is not lit
+    int count;
+
+    static size_t slot(int floor, bool up) {
+        return 2 * (size_t)floor + (up ? 1 : 0);
+    }
+};
+
+// ----------------------------------
+// Assignment solver
+// ----------------------------------
+// Hungarian algorithm (potentials form): assigns each of the n rows a
+// distinct column of an n x m cost matrix, n <= m, at minimum total cost.
+// O(n^2 * m). Returns the chosen column for every row.
+vector<int> solveAssignment(vector<vector<long>> const& cost) {
+    int n = (int)cost.size();
+    int m = n ? (int)cost[0].size() : 0;
+    const long INF = LONG_MAX / 4;
+    vector<long> u(n + 1, 0), v(m + 1, 0), minv(m + 1);
+    vector<int> p(m + 1, 0), way(m + 1, 0);   // p[j]: row owning column j
+    vector<char> used(m + 1);
+
+    for (int i = 1; i <= n; ++i) {
+        p[0] = i;
+        int j0 = 0;
+        fill(minv.begin(), minv.end(), INF);
+        fill(used.begin(), used.end(), 0);
+        do {
+            used[j0] = 1;
+            int i0 = p[j0], j1 = 0;
+            long delta = INF;
+            for (int j = 1; j <= m; ++j) {
+                if (used[j]) continue;
+                long cur = cost[i0 - 1][j - 1] - u[i0] - v[j];
+                if (cur < minv[j]) {
+                    minv[j] = cur;
+                    way[j]  = j0;
+                }
+                if (minv[j] < delta) {
+                    delta = minv[j];
+                    j1    = j;
+                }
+            }
+            for (int j = 0; j <= m; ++j) {
+                if (used[j]) {
+                    u[p[j]] += delta;
+                    v[j]    -= delta;
+                } else {
+                    minv[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while (p[j0] != 0);
+        do {
+            int j1 = way[j0];
+            p[j0] = p[j1];
+            j0 = j1;
+        } while (j0);
+    }
+
+    vector<int> col(n, -1);
+    for (int j = 1; j <= m; ++j)
+        if (p[j]) col[p[j] - 1] = j - 1;
+    return col;
+}
+
+// Floor range and fleet size of one zone, lowest zone first. Adjacent
+// zones share their boundary floor, which acts as the sky lobby.
+struct ZoneSpec {
+    int lowFloor;
+    int highFloor;
+    int cars;
+};
+
+// ----------------------------------
+// Building class
+// ----------------------------------
+class Building {
+public:
+    vector<Elevator> elevators;
+    vector<Zone> zones;
+    vector<int> zoneOf;   // floor -> lowest zone serving it
+    vector<int> carZone;  // car index -> its zone
+    HallCallTable hallCalls;
+    int numFloors;
+    long clock;   // ticks simulated so far
+    int reoptimizeEvery;   // ticks between global reassignment passes, 0 = off
+
+    // A hall call scheduled for a given tick (event-driven mode)
+    struct TimedCall {
+        long tick;
+        int  floor;
+    };
+
+    // Single zone: every car serves every floor
+    Building(int totFloors, int totElev)
+      : Building(totFloors, vector<ZoneSpec>{{1, totFloors, totElev}})
+    {}
+
+    // Zoned tower, e.g. {{1, 40, 4}, {40, 80, 4}} with a sky lobby at 40.
+    // Zones must go upward and each must start on the previous one's top
+    // floor; throws invalid_argument otherwise.
+    Building(int totFloors, vector<ZoneSpec> specs)
+      : zoneOf(totFloors + 1, -1)
+      , hallCalls(totFloors)
+      , numFloors(totFloors)
+      , clock(0)
+      , reoptimizeEvery(0)
+      , workTick(0)
+      , zonesBusy(0)
+      , stopping(false)
+    {
+        if (specs.empty())
+            throw invalid_argument("Building needs at least one zone");
+        for (size_t z = 0; z < specs.size(); ++z) {
+            ZoneSpec const& spec = specs[z];
+            if (spec.lowFloor < 1 || spec.highFloor > totFloors
+                || spec.lowFloor > spec.highFloor || spec.cars < 0
+                || (specs.size() > 1 && spec.lowFloor == spec.highFloor))
+                throw invalid_argument("Bad zone floor range or car count");
+            if (z > 0 && spec.lowFloor != specs[z - 1].highFloor)
+                throw invalid_argument("Zones must share one sky-lobby floor");
+        }
+
+        for (auto const& spec : specs) {
+            int first = (int)elevators.size();
+            for (int i = 0; i < spec.cars; ++i) {
+                elevators.emplace_back((int)elevators.size() + 1,
+                                       spec.lowFloor, spec.highFloor);
+                carZone.push_back((int)zones.size());
+            }
+            zones.emplace_back(spec.lowFloor, spec.highFloor,
+                               first, (int)elevators.size());
+        }
+        for (int z = 0; z < (int)zones.size(); ++z)
+            for (int f = max(1, zones[z].lowFloor);
+                 f <= min(numFloors, zones[z].highFloor); ++f)
+                if (zoneOf[f] < 0) zoneOf[f] = z;
+    }
+
+    // Zone that starts a trip: at a sky lobby, the one heading toward `to`
+    int zoneFor(int from, int to) const {
+        int z = zoneOf[from];
+        if (z + 1 < (int)zones.size() && zones[z + 1].serves(from)
+            && to > zones[z].highFloor)
+            ++z;
+        return z;
+    }
+
+    // Step each zone in turn and show status if any car moved
+    void stepAll() {
+        bool moved = false;
+        for (auto& zone : zones)
+            if (zone.step(elevators, cout)) moved = true;
+        finishTick(moved);
+    }
+
+    ~Building() {
+        {
+            lock_guard<mutex> lock(workMutex);
+            stopping = true;
+        }
+        workReady.notify_all();
+        for (auto& w : workers) w.join();
+    }
+
+    // Same tick as stepAll(), but each zone runs on its own thread.
+    // Workers are started once and reused for every tick.
+    void stepAllParallel() {
+        if (zones.size() < 2) {
+            stepAll();
+            return;
+        }
+        if (workers.empty()) {
+            zoneMoved.assign(zones.size(), 0);
+            for (size_t z = 0; z < zones.size(); ++z)
+                workers.emplace_back(&Building::workerLoop, this, z);
+        }
+        {
+            unique_lock<mutex> lock(workMutex);
+            zonesBusy = (int)zones.size();
+            ++workTick;
+            workReady.notify_all();
+            workDone.wait(lock, [this] { return zonesBusy == 0; });
+        }
+        finishTick(find(zoneMoved.begin(), zoneMoved.end(), 1) != zoneMoved.end());
+    }
+
+    // Enqueue a passenger trip; it is routed through sky lobbies as needed.
+    // Returns false (and queues nothing) if some leg has no car to take it.
+    bool requestTrip(int from, int to) {
+        if (from < 1 || from > numFloors || to < 1 || to > numFloors
+            || from == to || zoneOf[from] < 0 || zoneOf[to] < 0)
+            return false;
+        if (!routeServed(from, to)) return false;
+        int z = zoneFor(from, to);
+        if (!call(from, to > from, z)) return false;
+        zones[z].inbox.push_back({from, to, 0, -1});
+        return true;
+    }
+
+    // True if every zone on the way from `from` to `to` has a car serving
+    // the floor where the trip enters it
+    bool routeServed(int from, int to) const {
+        int z = zoneFor(from, to), entry = from;
+        while (true) {
+            Zone const& zone = zones[z];
+            bool served = false;
+            for (int i = zone.firstCar; i < zone.lastCar && !served; ++i)
+                served = elevators[i].serves(entry);
+            if (!served) return false;
+            if (zone.serves(to)) return true;
+            entry = zone.legTarget(to);
+            z += to > entry ? 1 : -1;
+        }
+    }
+
+    // Hall button press. A call already lit for this floor and direction
+    // is coalesced: no second car is sent. Returns false if no car of the
+    // zone serves the floor.
+    bool call(int floor, bool up) {
+        if (floor < 1 || floor > numFloors || zoneOf[floor] < 0) return false;
+        return call(floor, up, zoneFor(floor, up ? floor + 1 : floor - 1));
+    }
+
+    // Same, for a call that zone `z` has to answer
+    bool call(int floor, bool up, int z) {
+        if (hallCalls.pending(floor, up)) return true;
+        Zone& zone = zones[z];
+        int car = zone.dispatch(elevators, floor);
+        if (car < 0) return false;
+        hallCalls.assign(floor, up, car);
+        return true;
+    }
+
+    // Move a pending call to another car of the same zone
+    bool reassign(int floor, bool up, int carIdx) {
+        if (floor < 1 || floor > numFloors) return false;
+        int old = hallCalls.ownerOf(floor, up);
+        if (old < 0 || old == carIdx) return false;
+        Zone& zone = zones[carZone[old]];
+        if (!zone.ownsCar(carIdx) || !elevators[carIdx].serves(floor))
+            return false;
+        bool stillNeeded = zone.needsStop(elevators[old].id, floor)
+                        || hallCalls.ownerOf(floor, !up) == old;
+        if (!stillNeeded) elevators[old].removeRequest(floor);
+        elevators[carIdx].addRequest(floor,
+            floor > elevators[carIdx].currentFloor);
+        hallCalls.assign(floor, up, carIdx);
+        return true;
+    }
+
+    // Global re-optimization: per zone, solve the assignment of every
+    // pending hall call to a car on an ETA cost matrix, and move calls
+    // only if the optimum beats the current total. ETAs come from each
+    // car's committed stops only, so the current assignment and every
+    // candidate are scored alike and a repeat pass moves nothing.
+    // Returns calls moved.
+    int reoptimize() {
+        int movedCalls = 0;
+        vector<pair<int, bool>> all = hallCalls.pendingCalls();
+        for (int z = 0; z < (int)zones.size(); ++z) {
+            Zone const& zone = zones[z];
+            vector<pair<int, bool>> calls;
+            for (auto const& c : all)
+                if (zone.ownsCar(hallCalls.ownerOf(c.first, c.second)))
+                    calls.push_back(c);
+            int cars = zone.lastCar - zone.firstCar;
+            if (calls.empty() || cars < 2) continue;
+
+            // Each car gets `slots` columns; the k-th call a car takes
+            // costs k extra door stops, which spreads calls over the fleet.
+            // Slots cover current loads up to twice the fair share, which
+            // keeps the matrix at about 2n columns.
+            int n = (int)calls.size();
+            int fair = (n + cars - 1) / cars;
+            vector<int> load(cars, 0);
+            for (auto const& c : calls)
+                ++load[hallCalls.ownerOf(c.first, c.second) - zone.firstCar];
+            int slots = max(fair, min(2 * fair,
+                            *max_element(load.begin(), load.end())));
+            // Committed stops: the car's queue minus every floor with a
+            // call being reassigned, unless a rider still gets off there.
+            // Moving calls between cars then leaves these sets unchanged.
+            vector<char> callFloor(numFloors + 1, 0);
+            for (auto const& c : calls) callFloor[c.first] = 1;
+            vector<Sweep> plans;
+            plans.reserve(cars);
+            for (int c = 0; c < cars; ++c) {
+                Elevator const& el = elevators[zone.firstCar + c];
+                vector<int> dropped;
+                for (auto const* queue : {&el.upRequests, &el.downRequests})
+                    for (int f : *queue)
+                        if (callFloor[f] && !zone.needsStop(el.id, f))
+                            dropped.push_back(f);
+                plans.push_back(el.plannedSweep(dropped));
+            }
+
+            const long STOP = 1, NO_SERVICE = LONG_MAX / 16;
+            vector<vector<long>> cost(n, vector<long>(cars * slots));
+            auto fillRows = [&](int begin, int end) {
+                for (int i = begin; i < end; ++i)
+                    for (int c = 0; c < cars; ++c) {
+                        Elevator const& el = elevators[zone.firstCar + c];
+                        long eta = el.serves(calls[i].first)
+                                 ? plans[c].etaTo(calls[i].first) : NO_SERVICE;
+                        for (int k = 0; k < slots; ++k)
+                            cost[i][c * slots + k] = eta + k * STOP;
+                    }
+            };
+            // Threads only pay off on big matrices; small ones fill inline
+            const long PARALLEL_CELLS = 16384;
+            int fillers = (long)n * cars < PARALLEL_CELLS ? 1
+                        : max(1, min(n, (int)thread::hardware_concurrency()));
+            if (fillers == 1) {
+                fillRows(0, n);
+            } else {
+                vector<thread> pool;
+                for (int w = 0; w < fillers; ++w)
+                    pool.emplace_back(fillRows, n * w / fillers, n * (w + 1) / fillers);
+                for (auto& t : pool) t.join();
+            }
+
+            // Current total under the same model: a car's k-th call costs
+            // k extra stops, even past the last slot
+            long currentTotal = 0;
+            vector<int> taken(cars, 0);
+            for (int i = 0; i < n; ++i) {
+                int c = hallCalls.ownerOf(calls[i].first, calls[i].second)
+                      - zone.firstCar;
+                currentTotal += cost[i][c * slots] + taken[c]++ * STOP;
+            }
+
+            vector<int> col = solveAssignment(cost);
+            long bestTotal = 0;
+            for (int i = 0; i < n; ++i) bestTotal += cost[i][col[i]];
+            if (bestTotal >= currentTotal) continue;
+
+            for (int i = 0; i < n; ++i) {
+                int car = zone.firstCar + col[i] / slots;
+                if (reassign(calls[i].first, calls[i].second, car))
+                    ++movedCalls;
+            }
+        }
+        return movedCalls;
+    }
+
+    long tripsDelivered() const {
+        long total = 0;
+        for (auto const& zone : zones) total += zone.delivered;
+        return total;
+    }
+
+    // Event-driven advance: instead of stepping every tick, jump the clock
+    // straight to the next door opening. End state matches calling
+    // stepAll() until `tick`, but status is printed once per jump.
+    void advanceTo(long tick) {
+        while (clock < tick) {
+            long skip = tick - clock;
+            for (auto const& el : elevators)
+                skip = min(skip, el.ticksUntilArrival());
+            for (auto const& zone : zones)
+                if (!zone.inbox.empty()) skip = 0;
+            // Land on every re-optimization tick while calls are pending
+            if (reoptimizeEvery > 0 && hallCalls.size() > 0)
+                skip = min(skip, reoptimizeEvery - 1 - clock % reoptimizeEvery);
+
+            if (skip == 0) {            // someone arrives this tick
+                stepAll();
+                continue;
+            }
+            bool moved = false;
+            for (auto& el : elevators) {
+                int prev = el.currentFloor;
+                el.advance(skip);
+                if (el.currentFloor != prev) moved = true;
+            }
+            clock += skip;
+            if (moved) showStatus();
+        }
+    }
+
+    // Run a whole schedule of calls up to `endTick`; calls due at tick t
+    // are dispatched before tick t is stepped, like the CLI loop
+    void runSchedule(vector<TimedCall> calls, long endTick) {
+        stable_sort(calls.begin(), calls.end(),
+            [](TimedCall const& a, TimedCall const& b) { return a.tick < b.tick; });
+        for (auto const& c : calls) {
+            if (c.tick >= endTick) break;
+            advanceTo(c.tick);
+            if (c.floor >= 1 && c.floor <= numFloors)
+                dispatch(c.floor);
+        }
+        advanceTo(endTick);
+    }
+
+    // Settle hall calls answered this tick, hand trips that reached a sky
+    // lobby to the next zone, end the tick. Runs after all zones stepped,
+    // so the shared hall-call table is never touched from zone threads.
+    void finishTick(bool moved) {
+        for (auto& zone : zones) {
+            cout << zone.log.str();
+            zone.log.str("");
+            for (auto const& a : zone.arrivals)
+                answerCalls(zone, a.first, a.second);
+            zone.arrivals.clear();
+        }
+        for (auto& zone : zones) {
+            // requestTrip() checked that every leg has a car to take it
+            for (auto const& t : zone.outbox) {
+                int z = zoneFor(t.from, t.to);
+                if (call(t.from, t.to > t.from, z))
+                    zones[z].inbox.push_back(t);
+            }
+            zone.outbox.clear();
+        }
+        ++clock;
+        if (reoptimizeEvery > 0 && clock % reoptimizeEvery == 0)
+            reoptimize();
+        if (moved) showStatus();
+    }
+
+    // Doors opened at `floor`: any call there owned by this zone is served.
+    // If another car owned it, that car no longer needs to stop.
+    void answerCalls(Zone const& zone, int carIdx, int floor) {
+        for (bool up : {true, false}) {
+            int owner = hallCalls.ownerOf(floor, up);
+            if (owner < 0 || !zone.ownsCar(owner)) continue;
+            hallCalls.clear(floor, up);
+            if (owner != carIdx && !zone.needsStop(elevators[owner].id, floor))
+                elevators[owner].removeRequest(floor);
+        }
+    }
+
+    // Display all elevator states
+    void showStatus() const {
+        cout << "\n===== Building Status =====\n";
+        for (auto const& el : elevators)
+            el.showStatus();
+    }
+
+    // Single-button panel: coalesces with a call lit in either direction,
+    // otherwise registers as an up call (down on the top floor)
+    void dispatch(int floor) {
+        if (floor < 1 || floor > numFloors) return;
+        if (hallCalls.pending(floor, true) || hallCalls.pending(floor, false))
+            return;
+        call(floor, floor < numFloors);
     }
 
     // Serialize status to a single string
@@ -177,6 +860,34 @@ public:
         }
         return out.str();
     }
+
+private:
+    // Persistent zone workers for stepAllParallel()
+    mutex              workMutex;
+    condition_variable workReady;
+    condition_variable workDone;
+    long               workTick;    // bumped once per parallel tick
+    int                zonesBusy;   // zones still stepping this tick
+    bool               stopping;
+    vector<thread>     workers;
+    vector<char>       zoneMoved;
+
+    void workerLoop(size_t z) {
+        long seen = 0;
+        while (true) {
+            {
+                unique_lock<mutex> lock(workMutex);
+                workReady.wait(lock, [&] { return stopping || workTick != seen; });
+                if (stopping) return;
+                seen = workTick;
+            }
+            zoneMoved[z] = zones[z].step(elevators, zones[z].log);
+            {
+                lock_guard<mutex> lock(workMutex);
+                if (--zonesBusy == 0) workDone.notify_one();
+            }
+        }
+    }
 };
 
 // ----------------------------------
@@ -216,6 +927,10 @@ extern "C" {
     void stepSimulation() {
         gBuilding.stepAll();
     }
+    // Called from JS to advance many steps at once, skipping empty ticks
+    void advanceSimulation(int ticks) {
+        gBuilding.advanceTo(gBuilding.clock + ticks);
+    }
     // Called from JS to fetch the current status string
     const char* getStatus() {
         static string s;